@@ -1,4 +1,20 @@
 ﻿#include "framework.h"
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <random>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // NYILATKOZAT
 // ---------------------------------------------------------------------------------------------
@@ -20,9 +36,12 @@ const char* const vertexSource = R"(
 	#version 330				// Shader 3.3
 	precision highp float;		// normal floats, makes no difference on desktop computers
 	uniform mat4 MVP;			// uniform variable, the Model-View-Projection transformation matrix
-	layout(location = 0) in vec2 vp;	// Varying input: vp = vertex position is expected in attrib array 0
+	layout(location = 0) in vec2 vp;	// Varying input: vp = node position is expected in attrib array 0
+	layout(location = 1) in vec2 eltolas;	// circle outline offset around the node, (0, 0) for edges
 	void main() {
-		gl_Position = vec4(vp.x, vp.y, 0, 1) * MVP;		// transform vp from modeling space to normalized device space
+		vec2 p = vp + eltolas;
+		float z = 1 + dot(p, p);	// same projection as trf()
+		gl_Position = vec4(p.x / z, p.y / z, 0, 1) * MVP;		// transform vp from modeling space to normalized device space
 	}
 )";
 
@@ -47,6 +66,14 @@ const float DIST = 0.4f;
 const float SURLODAS = 0.01f;
 const float DT = 0.000008f;
 const float HIBAHATAR = 0.02f;
+const float CSILLAPITAS = 0.0001f;
+const float LEVAGAS = 0.6f;
+const float BOR = 0.1f;
+const float KERETIDO = 16.0f;
+const float NAGYITAS = 1.8f;
+const float KUSZOB_PX = 0.5f;
+const size_t OSSZEVONAS = 8;
+const int MAX_LEPES = 1000;
 bool dinSim = false;
 
 vec3 trf(vec2 inp, float nagyitas = 1.0f) {
@@ -67,7 +94,7 @@ void sikra(vec3& inp) {
 	inp.x = inp.x / inp.z;
 	inp.y = inp.y = inp.z;
 }
-vec3 Eukl(vec3 hip) {
+vec3 Eukl(const vec3& hip) {
 	vec3 ret;
 	ret.x = hip.x * hip.z;
 	ret.y = hip.y * hip.z;
@@ -77,7 +104,14 @@ float lorenz(const vec3& a, const vec3& b) {
 	return (a.x * b.x) + (a.y * b.y) - (a.z * b.z);
 }
 float dd(const vec3& a, const vec3& b) {
-	return acoshf(-lorenz(a, b));
+	return acoshf(fmaxf(1.0f, -lorenz(a, b)));
+}
+// Hiperbolikus eltolas (Lorentz boost), amely az origot az irany egysegvektor menten r tavolsagra viszi
+vec3 eltol(const vec3& p, const vec2& irany, const float r) {
+	float par = p.x * irany.x + p.y * irany.y;
+	float ujPar = par * coshf(r) + p.z * sinhf(r);
+	vec2 xy = vec2(p.x, p.y) + irany * (ujPar - par);
+	return vec3(xy.x, xy.y, par * sinhf(r) + p.z * coshf(r));
 }
 
 
@@ -92,6 +126,16 @@ struct grafPont {
 		pos.y = ((float)(rand() % 2000) - 1000.0f) / 1000.0f;
 		hip = trf(vec2(pos.x, pos.y));
 	}
+	explicit grafPont(const vec2& hol) {
+		pos = vec3(hol.x, hol.y, 0);
+		hip = trf(hol);
+	}
+	grafPont(std::mt19937& veletlen) {
+		std::uniform_int_distribution<int> eloszlas(0, 1999);
+		pos.x = ((float)eloszlas(veletlen) - 1000.0f) / 1000.0f;
+		pos.y = ((float)eloszlas(veletlen) - 1000.0f) / 1000.0f;
+		hip = trf(vec2(pos.x, pos.y));
+	}
 	void repos() {
 		pos = ujpos;
 		hip = trf(vec2(pos.x, pos.y)); 
@@ -112,21 +156,217 @@ float normTav(const grafPont& p, const grafPont& q) {
 }
 
 class Graf {
-	grafPont* nodes;
-	bool szMtx[NODES][NODES];
+	std::vector<grafPont> nodes;
+	std::vector<std::vector<bool>> szMtx;
+	std::vector<size_t> elA, elB;
+	std::vector<std::vector<size_t>> szomszedok;
+	bool levagas;
+	std::atomic<uint64_t> lepesSzam;
+	std::vector<std::vector<size_t>> kozeliek;
+	std::vector<std::vector<size_t>> racs;
+	std::vector<int> cellaX, cellaY;
+	std::vector<int> szintW, szintH;
+	std::vector<std::vector<int>> szintDb;
+	std::vector<std::vector<vec3>> szintOsszeg;
+	std::vector<vec3> epitesiPos;
 	unsigned int edgeVao;
 	unsigned int nodeVao;
-	unsigned int edgeVbo;
+	unsigned int edgeEbo;
 	unsigned int nodeVbo;
-public:
-	Graf() : edgeVao(0), edgeVbo(0), nodeVao(0), nodeVbo(0) {
-		nodes = new grafPont[NODES];
-		int szukseges_el = EDGES;
-		for (size_t x = 0; x < NODES - 1; ++x) {
-			for (size_t y = x + 1; y < NODES; ++y) {
-				szMtx[x][y] = false;
+	unsigned int korVbo;
+	bool elekFeltoltve;
+	std::vector<vec2> feltoltott;
+	std::mt19937* veletlen;
+
+	// Veletlen pontok: a kotegelt mod szalankenti generatorral, kulonben a rand()-dal
+	void veletlenPontok(const size_t n) {
+		nodes.clear();
+		nodes.reserve(n);
+		for (size_t i = 0; i < n; ++i) nodes.push_back(veletlen ? grafPont(*veletlen) : grafPont());
+	}
+
+	/*
+	* Egyetlen csomopontonkenti poziciobuffert hasznalnak a korok (peldanyositva, a statikus korvonal
+	* eltolasokkal) es az elek (indexelten, a statikus edgeEbo csomopontpar indexeivel).
+	*/
+	void initBuffers() {
+		glGenBuffers(1, &nodeVbo);
+		glGenBuffers(1, &korVbo);
+		glGenBuffers(1, &edgeEbo);
+		float kor[CIRCLE_RESOLUTION * 2];
+		//A forciklus forrasa: https://vik.wiki/Sz%C3%A1m%C3%ADt%C3%B3g%C3%A9pes_grafika_h%C3%A1zi_feladat_tutorial
+		for (size_t j = 0; j < CIRCLE_RESOLUTION; j++) {
+			float angle = float(j) / float(CIRCLE_RESOLUTION) * 2.0f * float(M_PI);
+			kor[j * 2] = RADIUS * cosf(angle);
+			kor[j * 2 + 1] = RADIUS * sinf(angle);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, korVbo);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(kor), kor, GL_STATIC_DRAW);
+
+		glGenVertexArrays(1, &nodeVao);
+		glBindVertexArray(nodeVao);
+		glBindBuffer(GL_ARRAY_BUFFER, nodeVbo);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+		glVertexAttribDivisor(0, 1);
+		glBindBuffer(GL_ARRAY_BUFFER, korVbo);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+
+		glGenVertexArrays(1, &edgeVao);
+		glBindVertexArray(edgeVao);
+		glBindBuffer(GL_ARRAY_BUFFER, nodeVbo);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, edgeEbo);
+	}
+
+	void elListaFrissit() {
+		elA.clear();
+		elB.clear();
+		szomszedok.assign(nodes.size(), std::vector<size_t>());
+		for (size_t x = 0; x + 1 < nodes.size(); ++x) {
+			for (size_t y = x + 1; y < nodes.size(); ++y) {
+				if (szMtx[x][y]) {
+					elA.push_back(x);
+					elB.push_back(y);
+					szomszedok[x].push_back(y);
+					szomszedok[y].push_back(x);
+				}
 			}
 		}
+		elekValtoztak();
+	}
+	void elekValtoztak() {
+		epitesiPos.clear();
+		kozeliek.clear();
+		elekFeltoltve = false;
+	}
+	/*
+	* Verlet listak: LEVAGAS + BOR meretu cellaracs, minden csomoponthoz a sajat es a 8 szomszedos cella
+	* nem szomszedos pontjai, ezekre pontosan szamolunk taszitast. A listak a cellatagsagbol epulnek, igy
+	* elavulva is minden pontpar pontosan egyszer szamit (kozel vagy a tavoli ter reszekent), ujraepites
+	* csak akkor kell, ha valamelyik pont a cellameret felenel tobbet mozdult az utolso epites ota.
+	*/
+	void kozeliekFrissit() {
+		const size_t n = nodes.size();
+		const float cella = LEVAGAS + BOR;
+		bool kell = epitesiPos.size() != n;
+		for (size_t i = 0; !kell && i < n; ++i) {
+			vec3 d = nodes[i].pos - epitesiPos[i];
+			kell = (d.x * d.x + d.y * d.y) > (cella * cella / 4.0f);
+		}
+		if (!kell) return;
+		float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+		for (size_t i = 0; i < n; ++i) {
+			if (i == 0 || nodes[i].pos.x < minX) minX = nodes[i].pos.x;
+			if (i == 0 || nodes[i].pos.y < minY) minY = nodes[i].pos.y;
+			if (i == 0 || nodes[i].pos.x > maxX) maxX = nodes[i].pos.x;
+			if (i == 0 || nodes[i].pos.y > maxY) maxY = nodes[i].pos.y;
+		}
+		const int w = int((maxX - minX) / cella) + 1, h = int((maxY - minY) / cella) + 1;
+		racs.assign(w * h, std::vector<size_t>());
+		cellaX.resize(n);
+		cellaY.resize(n);
+		std::vector<int>& cx = cellaX;
+		std::vector<int>& cy = cellaY;
+		for (size_t i = 0; i < n; ++i) {
+			cx[i] = int((nodes[i].pos.x - minX) / cella);
+			cy[i] = int((nodes[i].pos.y - minY) / cella);
+			racs[cy[i] * w + cx[i]].push_back(i);
+		}
+		kozeliek.assign(n, std::vector<size_t>());
+		for (size_t i = 0; i < n; ++i) {
+			for (int y = cy[i] - 1; y <= cy[i] + 1; ++y) {
+				for (int x = cx[i] - 1; x <= cx[i] + 1; ++x) {
+					if (x < 0 || y < 0 || x >= w || y >= h) continue;
+					for (size_t j : racs[y * w + x]) {
+						if (j != i && !szomszedos(i, j))
+							kozeliek[i].push_back(j);
+					}
+				}
+			}
+		}
+		// cellaszintek: a 0. szint maga a racs, a kovetkezo mindig 2x2 cellat von ossze, amig 2x2-nel nagyobb
+		szintW.assign(1, w);
+		szintH.assign(1, h);
+		while (szintW.back() > 2 || szintH.back() > 2) {
+			szintW.push_back((szintW.back() + 1) / 2);
+			szintH.push_back((szintH.back() + 1) / 2);
+		}
+		szintDb.resize(szintW.size());
+		szintOsszeg.resize(szintW.size());
+		for (size_t l = 0; l < szintW.size(); ++l) {
+			szintDb[l].assign(szintW[l] * szintH[l], 0);
+			szintOsszeg[l].assign(szintW[l] * szintH[l], vec3());
+		}
+		epitesiPos.resize(n);
+		for (size_t i = 0; i < n; ++i) epitesiPos[i] = nodes[i].pos;
+	}
+	/*
+	* A Verlet listakbol kimaradt, tavoli pontokat nem hagyjuk el: az F() taszitas nagysaga tavolsagfuggetlen,
+	* ezert egy cellacsoport hatasa jol kozelitheto darabszam * egysegvektor a kozeppontja felol. A szintenkenti
+	* darabszamokat es koordinataosszegeket minden lepesben a pontok aktualis helyebol szamoljuk.
+	*/
+	void cellakFrissit() {
+		for (size_t c = 0; c < racs.size(); ++c) {
+			vec3 sum;
+			for (size_t i : racs[c]) sum = sum + nodes[i].pos;
+			szintDb[0][c] = int(racs[c].size());
+			szintOsszeg[0][c] = sum;
+		}
+		for (size_t l = 1; l < szintW.size(); ++l) {
+			std::fill(szintDb[l].begin(), szintDb[l].end(), 0);
+			std::fill(szintOsszeg[l].begin(), szintOsszeg[l].end(), vec3());
+			const int aw = szintW[l - 1], ah = szintH[l - 1], fw = szintW[l];
+			for (int y = 0; y < ah; ++y) {
+				for (int x = 0; x < aw; ++x) {
+					const size_t c = (y / 2) * fw + x / 2;
+					szintDb[l][c] += szintDb[l - 1][y * aw + x];
+					szintOsszeg[l][c] = szintOsszeg[l][c] + szintOsszeg[l - 1][y * aw + x];
+				}
+			}
+		}
+	}
+	bool tavoliCella(const size_t i, const int x, const int y) const {
+		return abs(x - cellaX[i]) > 1 || abs(y - cellaY[i]) > 1;
+	}
+	/*
+	* Minden szinten a szulo cella 3x3-as kornyezetenek azon gyerekei hatnak, amelyek a sajat cella 3x3-as
+	* kornyezeten kivul esnek (a belsoket az eggyel finomabb szint vagy a Verlet lista adja). Szintenkent
+	* legfeljebb 27 cella, igy egy pontra O(log(cellak)) a tavoli ter.
+	*/
+	void tavoliTer(const size_t idx) {
+		grafPont& p = nodes[idx];
+		for (size_t l = 0; l < szintW.size(); ++l) {
+			const int x = cellaX[idx] >> l, y = cellaY[idx] >> l;
+			const int x0 = ((x >> 1) - 1) * 2, y0 = ((y >> 1) - 1) * 2;
+			for (int cy = y0; cy < y0 + 6; ++cy) {
+				for (int cx = x0; cx < x0 + 6; ++cx) {
+					if (cx < 0 || cy < 0 || cx >= szintW[l] || cy >= szintH[l]) continue;
+					if (abs(cx - x) <= 1 && abs(cy - y) <= 1) continue;
+					const size_t c = cy * szintW[l] + cx;
+					const int db = szintDb[l][c];
+					if (db == 0) continue;
+					vec3 kul(p.pos - szintOsszeg[l][c] / float(db));
+					float t = sqrtf(kul.x * kul.x + kul.y * kul.y);
+					if (t > 0.0f) p.ero = p.ero + kul * (CSILLAPITAS * db / t);
+				}
+			}
+		}
+		// a tavoli cellaban levo szomszedokat a cella taszitasa is tartalmazza, azt levonjuk
+		for (size_t j : szomszedok[idx]) {
+			if (!tavoliCella(idx, cellaX[j], cellaY[j])) continue;
+			vec3 kul(p.pos - nodes[j].pos);
+			float t = normTav(p, nodes[j]);
+			if (t > 0.0f) p.ero = p.ero - kul * (CSILLAPITAS / t);
+		}
+	}
+public:
+	Graf() : levagas(false), lepesSzam(0), edgeVao(0), nodeVao(0), edgeEbo(0), nodeVbo(0), korVbo(0), elekFeltoltve(false), veletlen(nullptr) {
+		nodes.resize(NODES);
+		szMtx.assign(NODES, std::vector<bool>(NODES, false));
+		int szukseges_el = EDGES;
 		while (szukseges_el != 0) {
 			int n1 = rand() % NODES;
 			int n2 = rand() % NODES;
@@ -138,111 +378,372 @@ public:
 				}
 			}
 		}
+		elListaFrissit();
+	}
+	Graf(const size_t n, const std::vector<std::pair<size_t, size_t>>& elek, std::mt19937* _veletlen = nullptr)
+		: levagas(false), lepesSzam(0), edgeVao(0), nodeVao(0), edgeEbo(0), nodeVbo(0), korVbo(0), elekFeltoltve(false), veletlen(_veletlen) {
+		veletlenPontok(n);
+		szMtx.assign(n, std::vector<bool>(n, false));
+		for (const std::pair<size_t, size_t>& e : elek) {
+			if (e.first >= n || e.second >= n) throw "Ervenytelen el";
+			if (e.first != e.second) szMtx[(e.first < e.second) ? e.first : e.second][(e.first < e.second) ? e.second : e.first] = true;
+		}
+		elListaFrissit();
 	}
 	grafPont& operator[](size_t idx) {
-		if (idx >= NODES) throw "Tulindexeles";
+		if (idx >= nodes.size()) throw "Tulindexeles";
 		return nodes[idx];
 	}
+	size_t size() const { return nodes.size(); }
+	size_t edgeCount() const { return elA.size(); }
+	bool szomszedos(size_t a, size_t b) const {
+		if (a == b) return false;
+		return szMtx[(a < b) ? a : b][(a < b) ? b : a];
+	}
 	bool edgeAt(const size_t idx, size_t& a, size_t& b) {
-		if (idx >= EDGES) throw "Sok lesz az az el!";
-		size_t cnt = 0;
-		for (size_t x = 0; x < NODES - 1; ++x) {
-			for (size_t y = x + 1; y < NODES; ++y) {
-				if (cnt == idx && szMtx[x][y] == true) {
-					a = x;
-					b = y;
-					return true;
+		if (idx >= elA.size()) throw "Sok lesz az az el!";
+		a = elA[idx];
+		b = elB[idx];
+		return true;
+	}
+	/*
+	* Futas kozbeni modositasok. Az uj csomopont a megadott helyre kerul, a grafot nem rendezzuk ujra,
+	* azt a hivo a relaxLocal()-lal teheti meg az erintett csomopontokra.
+	*/
+	size_t addNode(const vec2& hol) {
+		nodes.push_back(grafPont(hol));
+		for (size_t i = 0; i < szMtx.size(); ++i) szMtx[i].push_back(false);
+		szMtx.push_back(std::vector<bool>(nodes.size(), false));
+		szomszedok.push_back(std::vector<size_t>());
+		elekValtoztak();
+		return nodes.size() - 1;
+	}
+	void removeNode(const size_t idx) {
+		if (idx >= nodes.size()) throw "Tulindexeles";
+		nodes.erase(nodes.begin() + idx);
+		szMtx.erase(szMtx.begin() + idx);
+		for (size_t i = 0; i < szMtx.size(); ++i) szMtx[i].erase(szMtx[i].begin() + idx);
+		elListaFrissit();
+	}
+	bool addEdge(const size_t a, const size_t b) {
+		if (a >= nodes.size() || b >= nodes.size()) throw "Tulindexeles";
+		if (a == b || szomszedos(a, b)) return false;
+		szMtx[(a < b) ? a : b][(a < b) ? b : a] = true;
+		elA.push_back((a < b) ? a : b);
+		elB.push_back((a < b) ? b : a);
+		szomszedok[a].push_back(b);
+		szomszedok[b].push_back(a);
+		elekValtoztak();
+		return true;
+	}
+	bool removeEdge(const size_t a, const size_t b) {
+		if (a >= nodes.size() || b >= nodes.size()) throw "Tulindexeles";
+		if (!szomszedos(a, b)) return false;
+		szMtx[(a < b) ? a : b][(a < b) ? b : a] = false;
+		for (size_t e = 0; e < elA.size(); ++e) {
+			if (elA[e] == ((a < b) ? a : b) && elB[e] == ((a < b) ? b : a)) {
+				elA.erase(elA.begin() + e);
+				elB.erase(elB.begin() + e);
+				break;
+			}
+		}
+		szomszedok[a].erase(std::find(szomszedok[a].begin(), szomszedok[a].end(), b));
+		szomszedok[b].erase(std::find(szomszedok[b].begin(), szomszedok[b].end(), a));
+		elekValtoztak();
+		return true;
+	}
+	/*
+	* Csak a kiindulo csomopontok melyseg sugaru szomszedsagat szimulaljuk ujra a calcNode() eromodelljevel,
+	* a graf tobbi resze befagyasztva marad, de tovabbra is hat a mozgatott pontokra.
+	*/
+	float relaxLocal(const std::vector<size_t>& kezdo, const int melyseg = 2, const int lepesek = 200) {
+		std::vector<int> szint(nodes.size(), -1);
+		std::vector<size_t> aktiv;
+		for (size_t k : kezdo) {
+			if (k < nodes.size() && szint[k] < 0) {
+				szint[k] = 0;
+				aktiv.push_back(k);
+			}
+		}
+		for (size_t f = 0; f < aktiv.size(); ++f) {
+			size_t u = aktiv[f];
+			if (szint[u] >= melyseg) continue;
+			for (size_t v : szomszedok[u]) {
+				if (szint[v] < 0) {
+					szint[v] = szint[u] + 1;
+					aktiv.push_back(v);
 				}
-				if (szMtx[x][y] == true) { ++cnt; }
 			}
 		}
-		return false;
+		float sum = 0.0f;
+		for (int l = 0; l < lepesek; ++l) {
+			if (levagas) {
+				kozeliekFrissit();
+				cellakFrissit();
+			}
+			sum = 0.0f;
+			for (size_t i : aktiv) sum += calcNode(i);
+			for (size_t i : aktiv) nodes[i].repos();
+			++lepesSzam;
+			if (sum * DT < HIBAHATAR * 0.01f) break;
+		}
+		return sum;
 	}
-	void prepareCircle() {
-		if(nodeVao==0)
-			glGenVertexArrays(1, &nodeVao);
-		glBindVertexArray(nodeVao);
-		if(nodeVbo==0)
-			glGenBuffers(1, &nodeVbo);
+	static vec2 kepernyon(const vec2& p) {
+		vec3 t = trf(p);
+		return vec2(t.x * NAGYITAS * windowWidth / 2.0f, t.y * NAGYITAS * windowHeight / 2.0f);
+	}
+	/*
+	* Csak azokat a csomopontokat toltjuk fel, amelyek vetulete KUSZOB_PX-nel tobbet mozdult a legutobb
+	* feltoltott helyzethez kepest. Az OSSZEVONAS-nal kozelebbi piszkos tartomanyokat egy hivasba vonjuk.
+	* Igazat ad vissza, ha valami lathatoan valtozott.
+	*/
+	bool prepareCircle() {
+		if (nodeVbo == 0) initBuffers();
 		glBindBuffer(GL_ARRAY_BUFFER, nodeVbo);
-		float vertices[NODES * CIRCLE_RESOLUTION * 2];
-		for (size_t i = 0; i < NODES; ++i) {
-			float x = nodes[i].pos.x, y = nodes[i].pos.y;
-			//A forciklus forrasa: https://vik.wiki/Sz%C3%A1m%C3%ADt%C3%B3g%C3%A9pes_grafika_h%C3%A1zi_feladat_tutorial
-			for (size_t j = 0; j < CIRCLE_RESOLUTION; j++) {
-				float angle = float(j) / float(CIRCLE_RESOLUTION) * 2.0f * float(M_PI);
-				vec2 p(x + RADIUS * cosf(angle), y + RADIUS * sinf(angle));
-				vec3 t = trf(p);
-				vertices[(i * 32) + (j * 2)] = t.x;
-				vertices[(i * 32) + (j * 2) + 1] = t.y;
+		if (feltoltott.size() != nodes.size()) {
+			feltoltott.resize(nodes.size());
+			for (size_t i = 0; i < nodes.size(); ++i) feltoltott[i] = vec2(nodes[i].pos.x, nodes[i].pos.y);
+			glBufferData(GL_ARRAY_BUFFER, feltoltott.size() * sizeof(vec2), feltoltott.data(), GL_DYNAMIC_DRAW);
+			return true;
+		}
+		bool valtozott = false;
+		size_t eleje = 0, vege = 0;
+		for (size_t i = 0; i <= nodes.size(); ++i) {
+			bool piszkos = false;
+			if (i < nodes.size()) {
+				vec2 uj(nodes[i].pos.x, nodes[i].pos.y);
+				piszkos = length(kepernyon(uj) - kepernyon(feltoltott[i])) > KUSZOB_PX;
+				if (piszkos) feltoltott[i] = uj;
+			}
+			if (vege > eleje && (i == nodes.size() || (piszkos && i > vege + OSSZEVONAS))) {
+				glBufferSubData(GL_ARRAY_BUFFER, eleje * sizeof(vec2), (vege - eleje) * sizeof(vec2), &feltoltott[eleje]);
+				valtozott = true;
+				eleje = vege = 0;
+			}
+			if (piszkos) {
+				if (vege == eleje) eleje = i;
+				vege = i + 1;
 			}
 		}
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		glEnableVertexAttribArray(0);  // AttribArray 0
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+		return valtozott;
 	}
 	void drawCircle() {
 		int location = glGetUniformLocation(gpuProgram.getId(), "color");
 		glUniform3f(location, 0.0f, 1.0f, 0.0f);
-		float MVPtransf[4][4] = { 1.8f, 0, 0, 0, 0, 1.8f, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		float MVPtransf[4][4] = { NAGYITAS, 0, 0, 0, 0, NAGYITAS, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
 		location = glGetUniformLocation(gpuProgram.getId(), "MVP");
 		glUniformMatrix4fv(location, 1, GL_TRUE, &MVPtransf[0][0]);
 		glBindVertexArray(nodeVao); 
-		for (size_t i = 0; i < NODES; ++i) {
-			glDrawArrays(GL_TRIANGLE_FAN, i * CIRCLE_RESOLUTION, CIRCLE_RESOLUTION);
-		}
+		glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, CIRCLE_RESOLUTION, (GLsizei)nodes.size());
 	}
-	void prepareEdges() {
-		if (edgeVao == 0) glGenVertexArrays(1, &edgeVao);
-		glBindVertexArray(edgeVao);
-		if(edgeVbo==0) glGenBuffers(1, &edgeVbo);
-		glBindBuffer(GL_ARRAY_BUFFER, edgeVbo);
-		float vertices[EDGES * 4];
-		for (size_t i = 0; i < EDGES; ++i) {
-			size_t idxA;
-			size_t idxB;
-			if (edgeAt(i, idxA, idxB)) {
-				vertices[i * 4] = nodes[idxA].hip.x;
-				vertices[i * 4 + 1] = nodes[idxA].hip.y;
-				vertices[i * 4 + 2] = nodes[idxB].hip.x;
-				vertices[i * 4 + 3] = nodes[idxB].hip.y;
-			}
+	bool prepareEdges() {
+		if (nodeVbo == 0) initBuffers();
+		if (elekFeltoltve) return false;
+		std::vector<unsigned int> indices(elA.size() * 2);
+		for (size_t i = 0; i < elA.size(); ++i) {
+			indices[i * 2] = (unsigned int)elA[i];
+			indices[i * 2 + 1] = (unsigned int)elB[i];
 		}
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+		glBindVertexArray(edgeVao);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+		elekFeltoltve = true;
+		return true;
 	}
 	void drawEdges() {
 		int location = glGetUniformLocation(gpuProgram.getId(), "color");
 		glUniform3f(location, 0.0f, 0.0f, 1.0f);
-		float MVPtransf[4][4] = { 1.8f, 0, 0, 0, 0, 1.8f, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		float MVPtransf[4][4] = { NAGYITAS, 0, 0, 0, 0, NAGYITAS, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
 		location = glGetUniformLocation(gpuProgram.getId(), "MVP");
 		glUniformMatrix4fv(location, 1, GL_TRUE, &MVPtransf[0][0]);
 		glBindVertexArray(edgeVao);
-		glDrawArrays(GL_LINES, 0, EDGES * 2);
+		glVertexAttrib2f(1, 0.0f, 0.0f);
+		glDrawElements(GL_LINES, (GLsizei)(elA.size() * 2), GL_UNSIGNED_INT, NULL);
 	}
 	void magic() {
 		int legjobb = elmetszetek();
-		grafPont* gp = nodes;
+		std::vector<grafPont> gp = nodes;
 		int ig = legjobb *0.7;
 		int cnt = 300;
 		while(legjobb > ig && cnt >0) {
 			--cnt;
-			nodes = new grafPont[NODES];
+			veletlenPontok(gp.size());
 			if (elmetszetek() < legjobb) {
-				delete[] gp;
 				legjobb = elmetszetek();
 				gp = nodes;
 				break;
 			}
-			else delete[] nodes;
 		}
 		nodes = gp;
 	}
+	/*
+	* Graftavolsag alapu elrendezes: k pivot csomopontbol parhuzamos BFS, pivot MDS kezdo beagyazas,
+	* majd ritka stressz-majoralas a hiperbolikus tavolsaggal (dd()). Koltsege O(k*(N+E)) iteracionkent.
+	*/
+	void pivotMDS(size_t k = 10, const int iteraciok = 50) {
+		const size_t n = nodes.size();
+		if (n < 3) return;
+		if (k > n) k = n;
+		if (k < 3) k = (n < 3) ? n : 3;
+		std::vector<size_t> pivotok(k);
+		size_t eltolas = rand() % n;
+		for (size_t i = 0; i < k; ++i) pivotok[i] = (eltolas + i * n / k) % n;
+
+		std::vector<std::vector<int>> tav(k, std::vector<int>(n, -1));
+		auto bfs = [&](size_t pi) {
+			std::vector<int>& t = tav[pi];
+			std::vector<size_t> sor(1, pivotok[pi]);
+			t[pivotok[pi]] = 0;
+			for (size_t f = 0; f < sor.size(); ++f) {
+				for (size_t v : szomszedok[sor[f]]) {
+					if (t[v] < 0) {
+						t[v] = t[sor[f]] + 1;
+						sor.push_back(v);
+					}
+				}
+			}
+		};
+		size_t szalak = std::thread::hardware_concurrency();
+		if (szalak == 0) szalak = 1;
+		if (szalak > k) szalak = k;
+		std::vector<std::thread> munkasok;
+		for (size_t s = 0; s < szalak; ++s) {
+			munkasok.emplace_back([&, s]() {
+				for (size_t pi = s; pi < k; pi += szalak) bfs(pi);
+			});
+		}
+		for (std::thread& t : munkasok) t.join();
+
+		int atmero = 1;
+		for (size_t pi = 0; pi < k; ++pi)
+			for (size_t i = 0; i < n; ++i)
+				if (tav[pi][i] > atmero) atmero = tav[pi][i];
+		for (size_t pi = 0; pi < k; ++pi)
+			for (size_t i = 0; i < n; ++i)
+				if (tav[pi][i] < 0) tav[pi][i] = atmero + 1;
+
+		// Pivot MDS: duplan centralt negyzetes tavolsagok, C^T C ket legnagyobb sajatvektora hatvanyiteracioval
+		std::vector<float> C(n * k);
+		std::vector<float> sorAtl(n, 0.0f), oszlAtl(k, 0.0f);
+		float osszAtl = 0.0f;
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t pi = 0; pi < k; ++pi) {
+				float d2 = float(tav[pi][i]) * float(tav[pi][i]);
+				C[i * k + pi] = d2;
+				sorAtl[i] += d2 / k;
+				oszlAtl[pi] += d2 / n;
+				osszAtl += d2 / (n * k);
+			}
+		}
+		for (size_t i = 0; i < n; ++i)
+			for (size_t pi = 0; pi < k; ++pi)
+				C[i * k + pi] = -0.5f * (C[i * k + pi] - sorAtl[i] - oszlAtl[pi] + osszAtl);
+		std::vector<float> CtC(k * k, 0.0f);
+		for (size_t a = 0; a < k; ++a)
+			for (size_t b = 0; b < k; ++b)
+				for (size_t i = 0; i < n; ++i)
+					CtC[a * k + b] += C[i * k + a] * C[i * k + b];
+		std::vector<std::vector<float>> sajat(2, std::vector<float>(k));
+		for (int d = 0; d < 2; ++d) {
+			std::vector<float>& v = sajat[d];
+			for (size_t a = 0; a < k; ++a) v[a] = float(rand() % 1000) / 1000.0f - 0.5f;
+			for (int it = 0; it < 100; ++it) {
+				std::vector<float> w(k, 0.0f);
+				for (size_t a = 0; a < k; ++a)
+					for (size_t b = 0; b < k; ++b)
+						w[a] += CtC[a * k + b] * v[b];
+				if (d == 1) {
+					float vet = 0.0f;
+					for (size_t a = 0; a < k; ++a) vet += w[a] * sajat[0][a];
+					for (size_t a = 0; a < k; ++a) w[a] -= vet * sajat[0][a];
+				}
+				float hossz = 0.0f;
+				for (size_t a = 0; a < k; ++a) hossz += w[a] * w[a];
+				hossz = sqrtf(hossz);
+				if (hossz < 1e-12f) break;
+				for (size_t a = 0; a < k; ++a) v[a] = w[a] / hossz;
+			}
+		}
+		std::vector<vec2> xy(n);
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t a = 0; a < k; ++a) {
+				xy[i].x += C[i * k + a] * sajat[0][a];
+				xy[i].y += C[i * k + a] * sajat[1][a];
+			}
+		}
+		vec2 kozep;
+		for (size_t i = 0; i < n; ++i) kozep = kozep + xy[i] / float(n);
+		float elHossz = 0.0f;
+		for (size_t e = 0; e < elA.size(); ++e) elHossz += length(xy[elA[e]] - xy[elB[e]]);
+		elHossz = (elA.size() > 0 && elHossz > 0.0f) ? elHossz / elA.size() : 1.0f;
+
+		// Egy ugras kezdeti hiperbolikus hossza; a |pos| <= 1 korlatot a stressz utan kenyszeritjuk ki
+		const float ugras = fminf(DIST, 2.0f * asinhf(1.0f) / atmero);
+		std::vector<vec3> P(n);
+		for (size_t i = 0; i < n; ++i) {
+			vec2 u = (xy[i] - kozep) / elHossz * ugras;
+			float r = length(u);
+			vec2 irany = (r > 1e-6f) ? u / r : vec2(0, 0);
+			P[i] = vec3(irany.x * sinhf(r), irany.y * sinhf(r), coshf(r));
+		}
+
+		// Ritka stressz: minden csomopont a k pivothoz es a szomszedaihoz mert tavolsagot kozeliti
+		std::vector<std::vector<size_t>> pivotTag(n);
+		for (size_t pi = 0; pi < k; ++pi) pivotTag[pivotok[pi]].push_back(pi);
+		for (int it = 0; it < iteraciok; ++it) {
+			for (size_t i = 0; i < n; ++i) {
+				vec3 sum;
+				float sulyok = 0.0f;
+				auto tag = [&](size_t j, float cel) {
+					float delta = dd(P[i], P[j]);
+					if (j == i || delta < 1e-5f) return;
+					float w = 1.0f / (cel * cel);
+					vec3 v = (P[i] - (P[j] * coshf(delta))) / sinhf(delta);
+					sum = sum + ((P[j] * coshf(cel)) + (v * sinhf(cel))) * w;
+					sulyok += w;
+				};
+				for (size_t pi = 0; pi < k; ++pi) tag(pivotok[pi], tav[pi][i] * ugras);
+				for (size_t pi : pivotTag[i])
+					for (size_t j = 0; j < n; ++j) tag(j, tav[pi][j] * ugras);
+				for (size_t j : szomszedok[i]) tag(j, ugras);
+				if (sulyok <= 0.0f) continue;
+				float norma = sqrtf(fmaxf(1e-12f, -lorenz(sum, sum)));
+				P[i] = sum / norma;
+			}
+		}
+
+		// A kozeppont vissza az origoba, majd a sugarak aranyos szukitese, hogy |pos| <= 1 maradjon,
+		// mert a trf() vetites csak ott monoton
+		const vec3 origo(0, 0, 1);
+		vec3 kozepP;
+		for (size_t i = 0; i < n; ++i) kozepP = kozepP + P[i];
+		kozepP = kozepP / sqrtf(fmaxf(1e-12f, -lorenz(kozepP, kozepP)));
+		const float kozepR = dd(origo, kozepP);
+		if (kozepR > 1e-6f) {
+			vec2 irany = vec2(kozepP.x, kozepP.y) / sinhf(kozepR);
+			for (size_t i = 0; i < n; ++i) P[i] = eltol(P[i], irany, -kozepR);
+		}
+		const float hatar = 0.999f * asinhf(1.0f);
+		float maxR = 0.0f;
+		for (size_t i = 0; i < n; ++i) maxR = fmaxf(maxR, dd(origo, P[i]));
+		if (maxR > hatar) {
+			for (size_t i = 0; i < n; ++i) {
+				float r = dd(origo, P[i]);
+				if (r < 1e-6f) continue;
+				vec2 irany = vec2(P[i].x, P[i].y) / sinhf(r);
+				r = r * hatar / maxR;
+				P[i] = vec3(irany.x * sinhf(r), irany.y * sinhf(r), coshf(r));
+			}
+		}
+		for (size_t i = 0; i < n; ++i) {
+			nodes[i].pos = vec3(P[i].x, P[i].y, 0);
+			nodes[i].hip = trf(vec2(P[i].x, P[i].y));
+		}
+	}
 	int elmetszetek() {
 		int sum = 0;
-		for (size_t i = 0; i < EDGES - 1; ++i) {
-			for (size_t j = i + 1; j < EDGES; ++j) {
+		for (size_t i = 0; i + 1 < elA.size(); ++i) {
+			for (size_t j = i + 1; j < elA.size(); ++j) {
 				size_t idxA, idxB, idxC, idxD;
 				if(edgeAt(i,idxA, idxB) && edgeAt(j, idxC, idxD)){
 					if (metszikEgymast(nodes[idxA], nodes[idxB], nodes[idxC], nodes[idxD])) 
@@ -268,22 +769,145 @@ public:
 		if (y < ((y1<y2)?y1:y2) || y > ((y1>y2)?y1:y2) || y < ((y3<y4)?y3:y4) || y > ((y3>y4)?y3:y4)) return false;
 		return true;
 	}
-	float calcNode(const size_t idx) {
-		if (idx >= NODES) throw "tul lett indexelve";
+	std::vector<std::vector<size_t>> komponensek() const {
+		std::vector<std::vector<size_t>> ret;
+		std::vector<bool> volt(nodes.size(), false);
+		for (size_t s = 0; s < nodes.size(); ++s) {
+			if (volt[s]) continue;
+			volt[s] = true;
+			std::vector<size_t> komp(1, s);
+			for (size_t f = 0; f < komp.size(); ++f) {
+				for (size_t v : szomszedok[komp[f]]) {
+					if (!volt[v]) {
+						volt[v] = true;
+						komp.push_back(v);
+					}
+				}
+			}
+			ret.push_back(komp);
+		}
+		return ret;
+	}
+	/*
+	* Egy komponens onallo szimulacioja a sajat kozeppontja koruli lokalis keretben. Csak a komponens
+	* pontjait olvassa es irja, igy kulonbozo komponensek parhuzamosan futtathatok.
+	*/
+	void layoutKomponens(const std::vector<size_t>& komp, const int lepesek = 300) {
+		vec3 kozep;
+		for (size_t i : komp) kozep = kozep + nodes[i].pos / float(komp.size());
+		for (size_t i : komp) nodes[i].pos = nodes[i].pos - kozep;
+		for (int l = 0; l < lepesek && komp.size() > 1; ++l) {
+			for (size_t i : komp) calcNode(i, &komp);
+			for (size_t i : komp) nodes[i].pos = nodes[i].ujpos;
+			++lepesSzam;
+		}
+		for (size_t i : komp) nodes[i].hip = trf(vec2(nodes[i].pos.x, nodes[i].pos.y));
+	}
+	/*
+	* A lokalis keretben levo komponenseket hiperbolikus eltolassal (Lorentz boost) helyezzuk el:
+	* a legnagyobb kerul az origoba, a tobbi mohon a legkozelebbi szabad helyre.
+	*/
+	void pakol(const std::vector<std::vector<size_t>>& kompok) {
+		const vec3 origo(0, 0, 1);
+		std::vector<float> sugar(kompok.size(), 0.0f);
+		for (size_t c = 0; c < kompok.size(); ++c)
+			for (size_t i : kompok[c])
+				sugar[c] = fmaxf(sugar[c], dd(origo, hip(vec2(nodes[i].pos.x, nodes[i].pos.y))));
+		std::vector<size_t> sorrend(kompok.size());
+		for (size_t c = 0; c < sorrend.size(); ++c) sorrend[c] = c;
+		std::sort(sorrend.begin(), sorrend.end(), [&](size_t a, size_t b) { return sugar[a] > sugar[b]; });
+
+		const float hezag = DIST * 0.5f;
+		std::vector<vec3> kozepek;
+		std::vector<float> helySugar;
+		for (size_t c : sorrend) {
+			vec3 hely = origo;
+			bool jo = kozepek.empty();
+			for (float r = hezag; !jo; r += hezag * 0.5f) {
+				for (int a = 0; a < 12 && !jo; ++a) {
+					float szog = float(a) / 12.0f * 2.0f * float(M_PI) + r;
+					hely = vec3(cosf(szog) * sinhf(r), sinf(szog) * sinhf(r), coshf(r));
+					jo = true;
+					for (size_t o = 0; o < kozepek.size() && jo; ++o)
+						jo = dd(hely, kozepek[o]) >= sugar[c] + helySugar[o] + hezag;
+				}
+			}
+			kozepek.push_back(hely);
+			helySugar.push_back(sugar[c]);
+			float r = dd(origo, hely);
+			vec2 irany = (r > 1e-6f) ? vec2(hely.x, hely.y) / sinhf(r) : vec2(1, 0);
+			for (size_t i : kompok[c]) {
+				vec3 p = eltol(hip(vec2(nodes[i].pos.x, nodes[i].pos.y)), irany, r);
+				nodes[i].pos = vec3(p.x, p.y, 0);
+				nodes[i].hip = trf(vec2(p.x, p.y));
+			}
+		}
+	}
+	void komponensElrendezes(const int lepesek = 300) {
+		std::vector<std::vector<size_t>> kompok = komponensek();
+		std::vector<size_t> sorrend(kompok.size());
+		for (size_t c = 0; c < sorrend.size(); ++c) sorrend[c] = c;
+		std::sort(sorrend.begin(), sorrend.end(), [&](size_t a, size_t b) { return kompok[a].size() > kompok[b].size(); });
+		std::atomic<size_t> kovetkezo(0);
+		size_t szalak = std::thread::hardware_concurrency();
+		if (szalak == 0) szalak = 1;
+		if (szalak > kompok.size()) szalak = kompok.size();
+		std::vector<std::thread> munkasok;
+		for (size_t s = 0; s < szalak; ++s) {
+			munkasok.emplace_back([&]() {
+				for (size_t c = kovetkezo++; c < sorrend.size(); c = kovetkezo++)
+					layoutKomponens(kompok[sorrend[c]], lepesek);
+			});
+		}
+		for (std::thread& t : munkasok) t.join();
+		pakol(kompok);
+	}
+	float lepes() {
+		if (levagas) {
+			kozeliekFrissit();
+			cellakFrissit();
+		}
+		float sum = 0.0f;
+		for (size_t i = 0; i < nodes.size(); ++i)
+			sum += calcNode(i);
+		for (size_t i = 0; i < nodes.size(); ++i)
+			nodes[i].repos();
+		++lepesSzam;
+		return sum;
+	}
+	uint64_t getLepesSzam() const { return lepesSzam.load(); }
+	void setLevagas(const bool be) {
+		levagas = be;
+		epitesiPos.clear();
+	}
+	bool getLevagas() const { return levagas; }
+	float calcNode(const size_t idx, const std::vector<size_t>* halmaz = nullptr) {
+		if (idx >= nodes.size()) throw "tul lett indexelve";
 		grafPont& p = nodes[idx];
 		p.ujpos = p.pos;
 		p.ero = p.ero * 0;
 		p.v = p.v * 0;
-		for (size_t i = 0; i < NODES; ++i) {
-			if (i == idx) continue;
-			grafPont& q = nodes[i];
-			F(p, q, szMtx[(idx > i) ? i : idx][(idx > i) ? idx : i]);
-		}
-		grafPont kozepe;
-		kozepe.pos.x = 0;
-		kozepe.pos.y = 0;
+		if (halmaz != nullptr) {
+			for (size_t i : *halmaz) {
+				if (i == idx) continue;
+				F(p, nodes[i], szomszedos(idx, i));
+			}
+		}
+		else if (levagas && kozeliek.size() == nodes.size()) {
+			for (size_t i : szomszedok[idx]) F(p, nodes[i], true);
+			for (size_t i : kozeliek[idx]) F(p, nodes[i], false);
+			tavoliTer(idx);
+		}
+		else {
+			for (size_t i = 0; i < nodes.size(); ++i) {
+				if (i == idx) continue;
+				grafPont& q = nodes[i];
+				F(p, q, szomszedos(idx, i));
+			}
+		}
+		vec3 kozepe;
 		for (int i = 0; i < 5; ++i) {
-			vec3 kul(kozepe.pos - p.pos);
+			vec3 kul(kozepe - p.pos);
 			kul = kul * 0.001f;
 			p.ero = p.ero + kul;
 		}
@@ -294,7 +918,7 @@ public:
 		return sqrtf(p.v.x * p.v.x + p.v.y * p.v.y);
 	}
 	void F(grafPont& a, grafPont& b, const bool szomszedos) {
-		const float csillapitas = 0.0001f;
+		const float csillapitas = CSILLAPITAS;
 		if (szomszedos) {
 			if (normTav(a, b) < (DIST - HIBAHATAR)) {
 				vec3 kul(a.pos - b.pos);
@@ -308,18 +932,174 @@ public:
 			}
 		}
 		else {
+			// egybeeso pontoknak nincs iranya, a 0-val osztas NaN-t terjesztene az egesz grafra
+			const float t = normTav(a, b);
+			if (t <= 0.0f) return;
 			vec3 kul(a.pos - b.pos);
-			kul = kul * csillapitas * (1 / (normTav(a, b)));
+			kul = kul * csillapitas * (1 / t);
 			a.ero = a.ero + kul;
 		}
 	}
-	~Graf() {
-		delete[] nodes;
-	}
 };
 
 Graf g;
 
+/*
+* Az elrendezes kozzetetele osztott memoriaban (POSIX shm_open, Windowson nevesitett file mapping).
+* A nev folyamatonkent egyedi: "/grafhazi_layout_<pid>" (Windowson "Local\grafhazi_layout_<pid>"),
+* kizarolagosan jon letre es bezaraskor torlodik, igy minden szegmensnek pontosan egy iroja van.
+* Egy iro, tetszoleges szamu olvaso, zar nelkul. Minden mezo little-endian, a formatum:
+*
+*   Fejlec (64 bajt):
+*     uint32 magic        = KOZV_MAGIC ('GRAF')
+*     uint32 verzio       = KOZV_VERZIO
+*     uint32 slotok       a gyuru merete
+*     uint32 maxCsomopont egy slotba irhato csomopontok szama
+*     uint64 slotMeret    egy slot merete bajtban
+*     uint64 keretek      az eddig lezart keretek szama (atomikus, release)
+*     32 bajt tartalek
+*   slotok darab slot, az i. keret a (i % slotok). slotba kerul:
+*     uint64 sorszam      seqlock: iras alatt paratlan, lezarva 2 * (keret + 1)
+*     uint64 lepes        az eddig lefutott szimulacios lepesek szama
+*     uint32 csomopontok  ervenyes csomopontok szama (legfeljebb maxCsomopont)
+*     uint32 tartalek
+*     float  fokusz[16]   a rajzolashoz hasznalt transzformacio, sorfolytonosan
+*     float  hip[3 * maxCsomopont]  csomopontonkent a hiperboloid (x, y, z) pontja
+*
+* Olvasas: keretek betoltese, a slot sorszamanak olvasasa, masolas, majd a sorszam ujraolvasasa;
+* ha a ket sorszam elter vagy paratlan, a keretet az iro kozben felulirta.
+*/
+const uint32_t KOZV_MAGIC = 0x46415247;
+const uint32_t KOZV_VERZIO = 1;
+const uint32_t KOZV_SLOTOK = 8;
+const uint32_t KOZV_MAX_CSOMOPONT = 4096;
+
+struct KozvFejlec {
+	uint32_t magic;
+	uint32_t verzio;
+	uint32_t slotok;
+	uint32_t maxCsomopont;
+	uint64_t slotMeret;
+	std::atomic<uint64_t> keretek;
+	uint8_t tartalek[32];
+};
+struct KozvSlot {
+	std::atomic<uint64_t> sorszam;
+	uint64_t lepes;
+	uint32_t csomopontok;
+	uint32_t tartalek;
+	float fokusz[16];
+};
+static_assert(sizeof(KozvFejlec) == 64, "A fejlec merete a formatum resze");
+static_assert(sizeof(KozvSlot) == 88, "A slot fejlec merete a formatum resze");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "A folyamatok kozott csak zarmentes atomikus hasznalhato");
+
+class Kozvetito {
+	uint8_t* mem;
+	size_t meret;
+	std::string nev;
+#if defined(_WIN32)
+	HANDLE kezelo;
+#endif
+	KozvFejlec* fejlec() { return (KozvFejlec*)mem; }
+	KozvSlot* slot(uint64_t keret) {
+		return (KozvSlot*)(mem + sizeof(KozvFejlec) + (keret % KOZV_SLOTOK) * fejlec()->slotMeret);
+	}
+public:
+#if defined(_WIN32)
+	Kozvetito() : mem(nullptr), meret(0), kezelo(NULL) {}
+#else
+	Kozvetito() : mem(nullptr), meret(0) {}
+#endif
+	bool aktiv() const { return mem != nullptr; }
+	const std::string& getNev() const { return nev; }
+	bool megnyit() {
+		if (aktiv()) return true;
+		const uint64_t slotMeret = sizeof(KozvSlot) + 3 * sizeof(float) * KOZV_MAX_CSOMOPONT;
+		meret = sizeof(KozvFejlec) + KOZV_SLOTOK * slotMeret;
+#if defined(_WIN32)
+		nev = "Local\\grafhazi_layout_" + std::to_string(GetCurrentProcessId());
+		kezelo = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)meret, nev.c_str());
+		if (kezelo == NULL) return false;
+		if (GetLastError() == ERROR_ALREADY_EXISTS) {
+			CloseHandle(kezelo);
+			kezelo = NULL;
+			return false;
+		}
+		mem = (uint8_t*)MapViewOfFile(kezelo, FILE_MAP_ALL_ACCESS, 0, 0, meret);
+		if (mem == nullptr) {
+			CloseHandle(kezelo);
+			kezelo = NULL;
+			return false;
+		}
+#else
+		nev = "/grafhazi_layout_" + std::to_string(getpid());
+		int fd = shm_open(nev.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (fd < 0) return false;
+		if (ftruncate(fd, (off_t)meret) != 0) {
+			close(fd);
+			shm_unlink(nev.c_str());
+			return false;
+		}
+		void* p = mmap(NULL, meret, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) {
+			shm_unlink(nev.c_str());
+			return false;
+		}
+		mem = (uint8_t*)p;
+#endif
+		memset(mem, 0, meret);
+		KozvFejlec* f = fejlec();
+		f->slotok = KOZV_SLOTOK;
+		f->maxCsomopont = KOZV_MAX_CSOMOPONT;
+		f->slotMeret = slotMeret;
+		f->verzio = KOZV_VERZIO;
+		f->keretek.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		f->magic = KOZV_MAGIC;
+		return true;
+	}
+	void bezar() {
+		if (!aktiv()) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(mem);
+		CloseHandle(kezelo);
+		kezelo = NULL;
+#else
+		munmap(mem, meret);
+		shm_unlink(nev.c_str());
+#endif
+		mem = nullptr;
+	}
+	void kozzetesz(Graf& graf, const mat4& fokusz) {
+		if (!aktiv()) return;
+		KozvFejlec* f = fejlec();
+		const uint64_t keret = f->keretek.load(std::memory_order_relaxed);
+		KozvSlot* s = slot(keret);
+		s->sorszam.store(2 * keret + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		s->lepes = graf.getLepesSzam();
+		s->csomopontok = (uint32_t)((graf.size() < KOZV_MAX_CSOMOPONT) ? graf.size() : KOZV_MAX_CSOMOPONT);
+		memcpy(s->fokusz, (float*)fokusz, sizeof(s->fokusz));
+		float* hipAdat = (float*)(s + 1);
+		for (uint32_t i = 0; i < s->csomopontok; ++i) {
+			vec3 h = hip(vec2(graf[i].pos.x, graf[i].pos.y));
+			hipAdat[i * 3] = h.x;
+			hipAdat[i * 3 + 1] = h.y;
+			hipAdat[i * 3 + 2] = h.z;
+		}
+		s->sorszam.store(2 * (keret + 1), std::memory_order_release);
+		f->keretek.store(keret + 1, std::memory_order_release);
+	}
+	~Kozvetito() { bezar(); }
+};
+Kozvetito kozv;
+
+void kozzetetel() {
+	kozv.kozzetesz(g, ScaleMatrix(vec3(NAGYITAS, NAGYITAS, 1.0f)));
+}
+
 struct Mozgas {
 	vec2 kezdopont;
 	bool kezd;
@@ -352,14 +1132,14 @@ struct Mozgas {
 
 			printf("PQ: %.5f \t\t  M1M2: %.5f\n", dd(p, q), dd(m1, m2));
 
-			for (size_t i = 0; i < NODES; ++i) {
+			for (size_t i = 0; i < g.size(); ++i) {
 				tukrozes(g[i], m1);
 				tukrozes(g[i], m2);
 				g[i].pos = Eukl(g[i].hip);
 			}
 			kezdopont = vegpont;
-			g.prepareCircle();
-			glutPostRedisplay();
+			kozzetetel();
+			if (g.prepareCircle()) glutPostRedisplay();
 		}
 	}
 	void tukrozes(grafPont& gp, const vec3& m1) {
@@ -378,6 +1158,45 @@ struct Mozgas {
 };
 Mozgas mo;
 
+/*
+* Keretkoltseg alapu utemezo: egy onIdle() alatt annyi szimulacios lepest futtat, amennyi a mert
+* lepes-, feltoltes- es rajzolasi koltseg alapjan belefer a KERETIDO-be, utana egyszer tolt fel es rajzol.
+*/
+struct Utemezo {
+	typedef std::chrono::steady_clock ora;
+	float keretIdo;
+	float lepesKoltseg;
+	float feltoltesKoltseg;
+	float rajzKoltseg;
+	ora::time_point rajzKezdet;
+	Utemezo() : keretIdo(KERETIDO), lepesKoltseg(0.0f), feltoltesKoltseg(0.0f), rajzKoltseg(0.0f) {}
+	static float ms(ora::time_point a, ora::time_point b) {
+		return std::chrono::duration<float, std::milli>(b - a).count();
+	}
+	static float atlag(float regi, float uj) {
+		return (regi <= 0.0f) ? uj : regi * 0.8f + uj * 0.2f;
+	}
+	bool futtat(Graf& graf) {
+		ora::time_point kezdet = ora::now();
+		const float keret = keretIdo - feltoltesKoltseg - rajzKoltseg;
+		int lepesek = 0;
+		do {
+			ora::time_point t = ora::now();
+			graf.lepes();
+			lepesKoltseg = atlag(lepesKoltseg, ms(t, ora::now()));
+			++lepesek;
+		} while (lepesek < MAX_LEPES && ms(kezdet, ora::now()) + lepesKoltseg <= keret);
+		ora::time_point t = ora::now();
+		bool valtozott = graf.prepareCircle();
+		valtozott = graf.prepareEdges() || valtozott;
+		feltoltesKoltseg = atlag(feltoltesKoltseg, ms(t, ora::now()));
+		return valtozott;
+	}
+	void rajzElott() { rajzKezdet = ora::now(); }
+	void rajzUtan() { rajzKoltseg = atlag(rajzKoltseg, ms(rajzKezdet, ora::now())); }
+};
+Utemezo ut;
+
 void onInitialization() {
 	glViewport(0, 0, windowWidth, windowHeight);
 	g.prepareCircle();
@@ -385,10 +1204,12 @@ void onInitialization() {
 	gpuProgram.create(vertexSource, fragmentSource, "outColor");
 }
 void onDisplay() {
+	ut.rajzElott();
 	glClearColor(0, 0, 0, 0);
 	glClear(GL_COLOR_BUFFER_BIT);
 	g.drawEdges();
 	g.drawCircle();
+	ut.rajzUtan();
 	glutSwapBuffers();
 }
 void onKeyboard(unsigned char key, int pX, int pY) {
@@ -396,9 +1217,54 @@ void onKeyboard(unsigned char key, int pX, int pY) {
 		g.magic();
 		g.prepareCircle();
 		g.prepareEdges();
+		kozzetetel();
 		glutPostRedisplay();
 		dinSim =!dinSim;
 	}
+	else if (key == 's') {
+		if (kozv.aktiv()) kozv.bezar();
+		else if (kozv.megnyit()) printf("Kozzetetel: %s\n", kozv.getNev().c_str());
+		else printf("Az osztott memoria nem nyithato meg\n");
+	}
+	else if (key == 'c') {
+		g.setLevagas(!g.getLevagas());
+	}
+	else if (key == 'k') {
+		g.komponensElrendezes();
+		g.prepareCircle();
+		g.prepareEdges();
+		kozzetetel();
+		glutPostRedisplay();
+	}
+	else if (key == 'p') {
+		g.pivotMDS();
+		g.prepareCircle();
+		g.prepareEdges();
+		kozzetetel();
+		glutPostRedisplay();
+	}
+	else if (key == 'n' && g.size() > 0) {
+		size_t szomszed = rand() % g.size();
+		size_t uj = g.addNode(vec2(g[szomszed].pos.x + DIST, g[szomszed].pos.y));
+		g.addEdge(uj, szomszed);
+		g.relaxLocal(std::vector<size_t>{ uj });
+		g.prepareCircle();
+		g.prepareEdges();
+		kozzetetel();
+		glutPostRedisplay();
+	}
+	else if (key == 'x' && g.size() > 1) {
+		size_t idx = rand() % g.size();
+		std::vector<size_t> erintett;
+		for (size_t i = 0; i < g.size(); ++i)
+			if (g.szomszedos(idx, i)) erintett.push_back((i > idx) ? i - 1 : i);
+		g.removeNode(idx);
+		g.relaxLocal(erintett);
+		g.prepareCircle();
+		g.prepareEdges();
+		kozzetetel();
+		glutPostRedisplay();
+	}
 }
 void onKeyboardUp(unsigned char key, int pX, int pY) {
 }
@@ -415,14 +1281,158 @@ void onMouse(int button, int state, int pX, int pY) {
 }
 void onIdle() {
 	if (dinSim) {
-		float sum = 0.0f;
-		for (size_t i = 0; i < NODES; ++i)
-			sum+=g.calcNode(i);
-		for (size_t i = 0; i < NODES; ++i)
-			g[i].repos();
-			
-		g.prepareCircle();
-		g.prepareEdges();
-		glutPostRedisplay();
+		bool valtozott = ut.futtat(g);
+		kozzetetel();
+		if (valtozott) glutPostRedisplay();
+	}
+}
+
+/*
+* Kotegelt, nem interaktiv mod: Skeleton --batch [-j szalak] [-l lepesek] [-o kimenet] fajlok/konyvtarak...
+* Bemenet: elso szam a csomopontok szama (legfeljebb BATCH_MAX_CSOMOPONT), utana "a b" csomopontparok
+* (0-tol indexelve), # utan megjegyzes.
+* Minden graf a magic() heurisztikaval es a lepes() eromodellel rendezodik; a pozicio a <nev>.layout fajlba,
+* az osszesites (nev, csomopontok, elek, metszesek elotte es utana, ido) a standard kimenetre kerul.
+*/
+const size_t BATCH_MAX_CSOMOPONT = 20000;	// a szomszedsagi matrix N^2 bit
+
+struct BatchEredmeny {
+	std::string nev;
+	size_t csomopontok, elek;
+	int metszesElotte, metszesUtana;
+	float ido;
+	std::string hiba;
+};
+
+bool grafBeolvas(const std::string& utvonal, size_t& n, std::vector<std::pair<size_t, size_t>>& elek) {
+	std::ifstream be(utvonal);
+	if (!be) return false;
+	std::stringstream tartalom;
+	std::string sor;
+	while (std::getline(be, sor)) tartalom << sor.substr(0, sor.find('#')) << '\n';
+	if (!(tartalom >> n) || n > BATCH_MAX_CSOMOPONT) return false;
+	size_t a, b;
+	while (tartalom >> a) {
+		if (!(tartalom >> b)) return false;
+		elek.push_back(std::make_pair(a, b));
+	}
+	return tartalom.eof();
+}
+
+BatchEredmeny batchLayout(const std::string& utvonal, const std::string& kimenet, const int lepesek, std::mt19937& veletlen) {
+	BatchEredmeny e = { utvonal, 0, 0, 0, 0, 0.0f, "" };
+	std::chrono::steady_clock::time_point kezdet = std::chrono::steady_clock::now();
+	std::vector<std::pair<size_t, size_t>> elek;
+	if (!grafBeolvas(utvonal, e.csomopontok, elek)) {
+		e.hiba = "hibas grafleiro";
+		return e;
+	}
+	try {
+		Graf graf(e.csomopontok, elek, &veletlen);
+		e.elek = graf.edgeCount();
+		e.metszesElotte = graf.elmetszetek();
+		graf.magic();
+		for (int l = 0; l < lepesek; ++l) graf.lepes();
+		e.metszesUtana = graf.elmetszetek();
+		std::ofstream ki(kimenet);
+		if (!ki) {
+			e.hiba = "a kimenet nem irhato";
+			return e;
+		}
+		for (size_t i = 0; i < graf.size(); ++i) {
+			vec3 h = hip(vec2(graf[i].pos.x, graf[i].pos.y));
+			ki << i << ' ' << h.x << ' ' << h.y << ' ' << h.z << '\n';
+		}
+	}
+	catch (const char* uzenet) {
+		e.hiba = uzenet;
+	}
+	catch (const std::exception& kivetel) {
+		e.hiba = kivetel.what();
+	}
+	e.ido = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - kezdet).count();
+	return e;
+}
+
+int onBatch(int argc, char* argv[]) {
+	namespace fs = std::filesystem;
+	size_t szalak = std::thread::hardware_concurrency();
+	int lepesek = 500;
+	std::string kimenetDir;
+	std::vector<std::string> fajlok;
+	for (int i = 2; i < argc; ++i) {
+		std::string arg = argv[i];
+		std::error_code hiba;
+		if (arg == "-j" && i + 1 < argc) szalak = (size_t)atoi(argv[++i]);
+		else if (arg == "-l" && i + 1 < argc) lepesek = atoi(argv[++i]);
+		else if (arg == "-o" && i + 1 < argc) kimenetDir = argv[++i];
+		else if (fs::is_directory(arg, hiba)) {
+			std::vector<std::string> tartalom;
+			for (fs::directory_iterator f(arg, hiba), vege; !hiba && f != vege; f.increment(hiba))
+				if (f->is_regular_file(hiba) && f->path().extension() != ".layout") tartalom.push_back(f->path().string());
+			if (hiba) {
+				printf("%s nem olvashato: %s\n", arg.c_str(), hiba.message().c_str());
+				return 1;
+			}
+			std::sort(tartalom.begin(), tartalom.end());
+			fajlok.insert(fajlok.end(), tartalom.begin(), tartalom.end());
+		}
+		else fajlok.push_back(arg);
+	}
+	if (fajlok.empty()) {
+		printf("Hasznalat: %s --batch [-j szalak] [-l lepesek] [-o kimenet] fajlok/konyvtarak...\n", argv[0]);
+		return 1;
+	}
+	if (szalak == 0) szalak = 1;
+	if (szalak > fajlok.size()) szalak = fajlok.size();
+	// a kimeneti utvonalakat elore kepezzuk: ket bemenet nem irhatja ugyanazt a fajlt
+	std::vector<std::string> kimenetek(fajlok.size());
+	std::map<std::string, size_t> foglalt;
+	for (size_t i = 0; i < fajlok.size(); ++i) {
+		fs::path ki = fs::path(fajlok[i]).filename();
+		ki += ".layout";
+		ki = kimenetDir.empty() ? fs::path(fajlok[i]).parent_path() / ki : fs::path(kimenetDir) / ki;
+		std::error_code hiba;
+		fs::path kulcs = fs::absolute(ki, hiba);
+		std::pair<std::map<std::string, size_t>::iterator, bool> uj = foglalt.emplace((hiba ? ki : kulcs).lexically_normal().string(), i);
+		if (!uj.second) {
+			printf("%s es %s kimenete ugyanaz: %s\n", fajlok[uj.first->second].c_str(), fajlok[i].c_str(), ki.string().c_str());
+			return 1;
+		}
+		kimenetek[i] = ki.string();
+	}
+	if (!kimenetDir.empty()) {
+		std::error_code hiba;
+		fs::create_directories(kimenetDir, hiba);
+		if (hiba) {
+			printf("%s nem hozhato letre: %s\n", kimenetDir.c_str(), hiba.message().c_str());
+			return 1;
+		}
+	}
+
+	std::vector<BatchEredmeny> eredmenyek(fajlok.size());
+	std::atomic<size_t> kovetkezo(0);
+	std::vector<std::thread> munkasok;
+	const unsigned int mag = std::random_device()();
+	for (size_t s = 0; s < szalak; ++s) {
+		munkasok.emplace_back([&, s]() {
+			std::seed_seq sorozat{ mag, (unsigned int)s };
+			std::mt19937 veletlen(sorozat);
+			for (size_t i = kovetkezo++; i < fajlok.size(); i = kovetkezo++)
+				eredmenyek[i] = batchLayout(fajlok[i], kimenetek[i], lepesek, veletlen);
+		});
 	}
-}
\ No newline at end of file
+	for (std::thread& t : munkasok) t.join();
+
+	int hibak = 0;
+	printf("nev,csomopontok,elek,metszes_elotte,metszes_utana,ido_ms\n");
+	for (const BatchEredmeny& e : eredmenyek) {
+		if (!e.hiba.empty()) {
+			fprintf(stderr, "%s: %s\n", e.nev.c_str(), e.hiba.c_str());
+			++hibak;
+			continue;
+		}
+		printf("%s,%zu,%zu,%d,%d,%.3f\n", e.nev.c_str(), e.csomopontok, e.elek, e.metszesElotte, e.metszesUtana, e.ido);
+	}
+	return (hibak == 0) ? 0 : 2;
+}
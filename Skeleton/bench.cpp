@@ -0,0 +1,96 @@
+//=============================================================================================
+// Mikrobenchmark a framework.h vektor/matrix muveleteihez es a Graf forro pontjaihoz.
+// Nem resze a Skeleton projektnek, kulon forditando, pl.:
+//   g++ -std=c++17 -O2 bench.cpp -o bench -lGLEW -lGL -lglut -lpthread
+// Az eredmeny muveletenkenti ido nanoszekundumban.
+//=============================================================================================
+#include "Skeleton.cpp"
+#include <chrono>
+
+static volatile float nyelo;
+
+template<typename T>
+void meres(const char* nev, const size_t muveletek, T fv) {
+	fv();	// bemelegites
+	float legjobb = 0.0f;
+	for (int kor = 0; kor < 7; ++kor) {	// a legjobb kor szamit, ez kevesbe zajos
+		int ismetles = 0;
+		std::chrono::steady_clock::time_point kezdet = std::chrono::steady_clock::now();
+		float eltelt = 0.0f;
+		do {
+			fv();
+			++ismetles;
+			eltelt = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - kezdet).count();
+		} while (eltelt < 3e7f);
+		float ido = eltelt / (float(ismetles) * muveletek);
+		if (kor == 0 || ido < legjobb) legjobb = ido;
+	}
+	printf("%-28s %10.3f ns/muvelet\n", nev, legjobb);
+}
+
+int main() {
+	const size_t N = 4096;
+	std::vector<vec3> a3(N), b3(N), c3(N);
+	std::vector<vec4> a4(N), b4(N), c4(N);
+	for (size_t i = 0; i < N; ++i) {
+		a3[i] = vec3(float(i), float(i) * 0.5f, 1.0f);
+		b3[i] = vec3(0.25f, float(i) * 0.1f, 2.0f);
+		a4[i] = vec4(float(i), 1.0f, 2.0f, 3.0f);
+		b4[i] = vec4(0.5f, float(i), 0.25f, 1.0f);
+	}
+	mat4 m = RotationMatrix(0.3f, vec3(0, 0, 1)) * TranslateMatrix(vec3(1, 2, 3));
+
+	meres("vec3 a + b * s", N, [&]() {
+		for (size_t i = 0; i < N; ++i) c3[i] = a3[i] + b3[i] * 0.5f;
+		nyelo = c3[N / 2].x;
+	});
+	meres("vec3 a - b, dot", N, [&]() {
+		float s = 0.0f;
+		for (size_t i = 0; i < N; ++i) s += dot(a3[i] - b3[i], b3[i]);
+		nyelo = s;
+	});
+	meres("vec3 length", N, [&]() {
+		float s = 0.0f;
+		for (size_t i = 0; i < N; ++i) s += length(a3[i]);
+		nyelo = s;
+	});
+	meres("lorenz + dd", N, [&]() {
+		float s = 0.0f;
+		for (size_t i = 1; i < N; ++i) s += dd(hip(vec2(b3[i].x, b3[i].y)), hip(vec2(b3[i - 1].x, b3[i - 1].y)));
+		nyelo = s;
+	});
+	meres("vec4 a + b * s", N, [&]() {
+		for (size_t i = 0; i < N; ++i) c4[i] = a4[i] + b4[i] * 0.5f;
+		nyelo = c4[N / 2].x;
+	});
+	meres("vec4 += ", N, [&]() {
+		for (size_t i = 0; i < N; ++i) c4[i] += a4[i];
+		nyelo = c4[N / 2].w;
+	});
+	meres("vec4 * mat4", N, [&]() {
+		for (size_t i = 0; i < N; ++i) c4[i] = a4[i] * m;
+		nyelo = c4[N / 2].y;
+	});
+	std::vector<mat4> ms(256, m);
+	meres("mat4 * mat4", ms.size(), [&]() {
+		for (size_t i = 1; i < ms.size(); ++i) ms[i] = ms[i - 1] * m;
+		nyelo = ms.back()[1][2];
+	});
+
+	srand(7);
+	Graf graf;
+	const size_t n = graf.size(), e = graf.edgeCount();
+	meres("metszikEgymast", e * (e - 1) / 2, [&]() {
+		nyelo = float(graf.elmetszetek());
+	});
+	meres("F", n * (n - 1), [&]() {
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				if (i != j) graf.F(graf[i], graf[j], graf.szomszedos(i, j));
+		nyelo = graf[0].ero.x;
+	});
+	meres("lepes (50 csomopont)", 1, [&]() {
+		nyelo = graf.lepes();
+	});
+	return 0;
+}
@@ -26,8 +26,13 @@ void onMouse(int button, int state, int pX, int pY);
 // Idle event indicating that some time elapsed: do animation here
 void onIdle();
 
+// Non-interactive batch layout of graph files, returns the process exit code
+int onBatch(int argc, char * argv[]);
+
 // Entry point of the application
 int main(int argc, char * argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "--batch") return onBatch(argc, argv);
+
 	// Initialize GLUT, Glew and OpenGL 
 	glutInit(&argc, argv);
 
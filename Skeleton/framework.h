@@ -12,6 +12,15 @@
 #include <vector>
 #include <string>
 
+// SIMD backend for vec4 / mat4 (SSE on x86/x64, NEON on ARM, scalar otherwise)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FRAMEWORK_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FRAMEWORK_NEON
+#endif
+
 #if defined(__APPLE__)
 #include <GLUT/GLUT.h>
 #include <OpenGL/gl3.h>
@@ -31,7 +40,7 @@ struct vec2 {
 //--------------------------
 	float x, y;
 
-	vec2(float x0 = 0, float y0 = 0) { x = x0; y = y0; }
+	constexpr vec2(float x0 = 0, float y0 = 0) : x(x0), y(y0) {}
 	vec2 operator*(float a) const { return vec2(x * a, y * a); }
 	vec2 operator/(float a) const { return vec2(x / a, y / a); }
 	vec2 operator+(const vec2& v) const { return vec2(x + v.x, y + v.y); }
@@ -50,13 +59,57 @@ inline vec2 normalize(const vec2& v) { return v * (1 / length(v)); }
 
 inline vec2 operator*(float a, const vec2& v) { return vec2(v.x * a, v.y * a); }
 
+// vec3 is padded to 16 bytes on SIMD targets. The fourth lane starts at 0 but is not kept there
+// (0/0 or 0*inf make it NaN), so only x, y, z are meaningful. Pass aligned types by const&:
+// 32-bit MSVC cannot pass over-aligned parameters by value (C2719).
+#if defined(FRAMEWORK_SSE)
+//--------------------------
+struct alignas(16) vec3 {
+//--------------------------
+	float x, y, z;
+private:
+	float pad;
+public:
+	constexpr vec3(float x0 = 0, float y0 = 0, float z0 = 0) : x(x0), y(y0), z(z0), pad(0) {}
+	constexpr vec3(vec2 v) : x(v.x), y(v.y), z(0), pad(0) {}
+	vec3(__m128 m) { _mm_store_ps(&x, m); }
+	__m128 simd() const { return _mm_load_ps(&x); }
+
+	vec3 operator*(float a) const { return vec3(_mm_mul_ps(simd(), _mm_set1_ps(a))); }
+	vec3 operator/(float a) const { return vec3(_mm_div_ps(simd(), _mm_set1_ps(a))); }
+	vec3 operator+(const vec3& v) const { return vec3(_mm_add_ps(simd(), v.simd())); }
+	vec3 operator-(const vec3& v) const { return vec3(_mm_sub_ps(simd(), v.simd())); }
+	vec3 operator*(const vec3& v) const { return vec3(_mm_mul_ps(simd(), v.simd())); }
+	vec3 operator-()  const { return vec3(_mm_sub_ps(_mm_setzero_ps(), simd())); }
+};
+#elif defined(FRAMEWORK_NEON)
+//--------------------------
+struct alignas(16) vec3 {
+//--------------------------
+	float x, y, z;
+private:
+	float pad;
+public:
+	constexpr vec3(float x0 = 0, float y0 = 0, float z0 = 0) : x(x0), y(y0), z(z0), pad(0) {}
+	constexpr vec3(vec2 v) : x(v.x), y(v.y), z(0), pad(0) {}
+	vec3(float32x4_t m) { vst1q_f32(&x, m); }
+	float32x4_t simd() const { return vld1q_f32(&x); }
+
+	vec3 operator*(float a) const { return vec3(vmulq_n_f32(simd(), a)); }
+	vec3 operator/(float a) const { return vec3(vmulq_n_f32(simd(), 1.0f / a)); }
+	vec3 operator+(const vec3& v) const { return vec3(vaddq_f32(simd(), v.simd())); }
+	vec3 operator-(const vec3& v) const { return vec3(vsubq_f32(simd(), v.simd())); }
+	vec3 operator*(const vec3& v) const { return vec3(vmulq_f32(simd(), v.simd())); }
+	vec3 operator-()  const { return vec3(vnegq_f32(simd())); }
+};
+#else
 //--------------------------
 struct vec3 {
 //--------------------------
 	float x, y, z;
 
-	vec3(float x0 = 0, float y0 = 0, float z0 = 0) { x = x0; y = y0; z = z0; }
-	vec3(vec2 v) { x = v.x; y = v.y; z = 0; }
+	constexpr vec3(float x0 = 0, float y0 = 0, float z0 = 0) : x(x0), y(y0), z(z0) {}
+	constexpr vec3(vec2 v) : x(v.x), y(v.y), z(0) {}
 
 	vec3 operator*(float a) const { return vec3(x * a, y * a, z * a); }
 	vec3 operator/(float a) const { return vec3(x / a, y / a, z / a); }
@@ -65,6 +118,7 @@ struct vec3 {
 	vec3 operator*(const vec3& v) const { return vec3(x * v.x, y * v.y, z * v.z); }
 	vec3 operator-()  const { return vec3(-x, -y, -z); }
 };
+#endif
 
 inline float dot(const vec3& v1, const vec3& v2) { return (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z); }
 
@@ -79,29 +133,47 @@ inline vec3 cross(const vec3& v1, const vec3& v2) {
 inline vec3 operator*(float a, const vec3& v) { return vec3(v.x * a, v.y * a, v.z * a); }
 
 //--------------------------
-struct vec4 {
+struct alignas(16) vec4 {
 //--------------------------
 	float x, y, z, w;
 
-	vec4(float x0 = 0, float y0 = 0, float z0 = 0, float w0 = 0) { x = x0; y = y0; z = z0; w = w0; }
+	constexpr vec4(float x0 = 0, float y0 = 0, float z0 = 0, float w0 = 0) : x(x0), y(y0), z(z0), w(w0) {}
 	float& operator[](int j) { return *(&x + j); }
 	float operator[](int j) const { return *(&x + j); }
 
+#if defined(FRAMEWORK_SSE)
+	vec4(__m128 m) { _mm_store_ps(&x, m); }
+	__m128 simd() const { return _mm_load_ps(&x); }
+	vec4 operator*(float a) const { return vec4(_mm_mul_ps(simd(), _mm_set1_ps(a))); }
+	vec4 operator/(float d) const { return vec4(_mm_div_ps(simd(), _mm_set1_ps(d))); }
+	vec4 operator+(const vec4& v) const { return vec4(_mm_add_ps(simd(), v.simd())); }
+	vec4 operator-(const vec4& v) const { return vec4(_mm_sub_ps(simd(), v.simd())); }
+	vec4 operator*(const vec4& v) const { return vec4(_mm_mul_ps(simd(), v.simd())); }
+	void operator+=(const vec4& right) { _mm_store_ps(&x, _mm_add_ps(simd(), right.simd())); }
+#elif defined(FRAMEWORK_NEON)
+	vec4(float32x4_t m) { vst1q_f32(&x, m); }
+	float32x4_t simd() const { return vld1q_f32(&x); }
+	vec4 operator*(float a) const { return vec4(vmulq_n_f32(simd(), a)); }
+	vec4 operator/(float d) const { return vec4(vmulq_n_f32(simd(), 1.0f / d)); }
+	vec4 operator+(const vec4& v) const { return vec4(vaddq_f32(simd(), v.simd())); }
+	vec4 operator-(const vec4& v) const { return vec4(vsubq_f32(simd(), v.simd())); }
+	vec4 operator*(const vec4& v) const { return vec4(vmulq_f32(simd(), v.simd())); }
+	void operator+=(const vec4& right) { vst1q_f32(&x, vaddq_f32(simd(), right.simd())); }
+#else
 	vec4 operator*(float a) const { return vec4(x * a, y * a, z * a, w * a); }
 	vec4 operator/(float d) const { return vec4(x / d, y / d, z / d, w / d); }
 	vec4 operator+(const vec4& v) const { return vec4(x + v.x, y + v.y, z + v.z, w + v.w); }
 	vec4 operator-(const vec4& v)  const { return vec4(x - v.x, y - v.y, z - v.z, w - v.w); }
 	vec4 operator*(const vec4& v) const { return vec4(x * v.x, y * v.y, z * v.z, w * v.w); }
-	void operator+=(const vec4 right) { x += right.x; y += right.y; z += right.z, w += right.z; }
+	void operator+=(const vec4& right) { x += right.x; y += right.y; z += right.z; w += right.w; }
+#endif
 };
 
 inline float dot(const vec4& v1, const vec4& v2) {
 	return (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w * v2.w);
 }
 
-inline vec4 operator*(float a, const vec4& v) {
-	return vec4(v.x * a, v.y * a, v.z * a, v.w * a);
-}
+inline vec4 operator*(float a, const vec4& v) { return v * a; }
 
 //---------------------------
 struct mat4 { // row-major matrix 4x4
@@ -109,26 +181,35 @@ struct mat4 { // row-major matrix 4x4
 	vec4 rows[4];
 public:
 	mat4() {}
-	mat4(float m00, float m01, float m02, float m03,
+	constexpr mat4(float m00, float m01, float m02, float m03,
 		float m10, float m11, float m12, float m13,
 		float m20, float m21, float m22, float m23,
-		float m30, float m31, float m32, float m33) {
-		rows[0][0] = m00; rows[0][1] = m01; rows[0][2] = m02; rows[0][3] = m03;
-		rows[1][0] = m10; rows[1][1] = m11; rows[1][2] = m12; rows[1][3] = m13;
-		rows[2][0] = m20; rows[2][1] = m21; rows[2][2] = m22; rows[2][3] = m23;
-		rows[3][0] = m30; rows[3][1] = m31; rows[3][2] = m32; rows[3][3] = m33;
-	}
-	mat4(vec4 it, vec4 jt, vec4 kt, vec4 ot) {
-		rows[0] = it; rows[1] = jt; rows[2] = kt; rows[3] = ot;
-	}
+		float m30, float m31, float m32, float m33)
+		: rows{ vec4(m00, m01, m02, m03), vec4(m10, m11, m12, m13),
+				vec4(m20, m21, m22, m23), vec4(m30, m31, m32, m33) } {}
+	constexpr mat4(const vec4& it, const vec4& jt, const vec4& kt, const vec4& ot) : rows{ it, jt, kt, ot } {}
 
 	vec4& operator[](int i) { return rows[i]; }
-	vec4 operator[](int i) const { return rows[i]; }
+	const vec4& operator[](int i) const { return rows[i]; }
 	operator float*() const { return (float*)this; }
 };
 
 inline vec4 operator*(const vec4& v, const mat4& mat) {
+#if defined(FRAMEWORK_SSE)
+	__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), mat.rows[0].simd());
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), mat.rows[1].simd()));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), mat.rows[2].simd()));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.w), mat.rows[3].simd()));
+	return vec4(r);
+#elif defined(FRAMEWORK_NEON)
+	float32x4_t r = vmulq_n_f32(mat.rows[0].simd(), v.x);
+	r = vmlaq_n_f32(r, mat.rows[1].simd(), v.y);
+	r = vmlaq_n_f32(r, mat.rows[2].simd(), v.z);
+	r = vmlaq_n_f32(r, mat.rows[3].simd(), v.w);
+	return vec4(r);
+#else
 	return v[0] * mat[0] + v[1] * mat[1] + v[2] * mat[2] + v[3] * mat[3];
+#endif
 }
 
 inline mat4 operator*(const mat4& left, const mat4& right) {
@@ -137,23 +218,23 @@ inline mat4 operator*(const mat4& left, const mat4& right) {
 	return result;
 }
 
-inline mat4 TranslateMatrix(vec3 t) {
+inline mat4 TranslateMatrix(const vec3& t) {
 	return mat4(vec4(1,   0,   0,   0),
 			    vec4(0,   1,   0,   0),
 				vec4(0,   0,   1,   0),
 				vec4(t.x, t.y, t.z, 1));
 }
 
-inline mat4 ScaleMatrix(vec3 s) {
+inline mat4 ScaleMatrix(const vec3& s) {
 	return mat4(vec4(s.x, 0,   0,   0),
 			    vec4(0,   s.y, 0,   0),
 				vec4(0,   0,   s.z, 0),
 				vec4(0,   0,   0,   1));
 }
 
-inline mat4 RotationMatrix(float angle, vec3 w) {
+inline mat4 RotationMatrix(float angle, const vec3& axis) {
 	float c = cosf(angle), s = sinf(angle);
-	w = normalize(w);
+	vec3 w = normalize(axis);
 	return mat4(vec4(c * (1 - w.x*w.x) + w.x*w.x, w.x*w.y*(1 - c) + w.z*s, w.x*w.z*(1 - c) - w.y*s, 0),
 			    vec4(w.x*w.y*(1 - c) - w.z*s, c * (1 - w.y*w.y) + w.y*w.y, w.y*w.z*(1 - c) + w.x*s, 0),
 			    vec4(w.x*w.z*(1 - c) + w.y*s, w.y*w.z*(1 - c) - w.x*s, c * (1 - w.z*w.z) + w.z*w.z, 0),